@@ -29,9 +29,28 @@ Client: Testing the same client code with the third factory type:
 The result of the product B3.
 The result of the B3 collaborating with ( The result of the product A3. )
 
+Client: Testing batched client code grouped by factory type:
+The result of the product B1.
+The result of the B1 collaborating with ( The result of the product A1. )
+The result of the product C1.
+The result of the C1 collaborating with ( The result of the product A1. )
+The result of the C1 collaborating with ( The result of the product B1. )
+The result of the product B2.
+The result of the B2 collaborating with ( The result of the product A2. )
+The result of the product C2.
+The result of the C2 collaborating with ( The result of the product A2. )
+The result of the C2 collaborating with ( The result of the product B2. )
+The result of the product B2.
+The result of the B2 collaborating with ( The result of the product A2. )
+The result of the product C2.
+The result of the C2 collaborating with ( The result of the product A2. )
+The result of the C2 collaborating with ( The result of the product B2. )
  */
 
 #include <iostream>
+#include <memory>
+#include <typeinfo>
+#include <vector>
 /**
  * każdy z produktów danej fabryki ma jakiś interface.
  * konkretne produkty muszą dziedziczyć ten interface
@@ -48,7 +67,7 @@ public:
  * konkretne produkty o pewnym interface
  *
  */
-class ConcreteProductA1 : public AbstractProductA
+class ConcreteProductA1 final : public AbstractProductA
 {
 public:
     std::string UsefulFunctionA() const override
@@ -57,16 +76,18 @@ public:
     }
 };
 
-class ConcreteProductA2 : public AbstractProductA
+class ConcreteProductA2 final : public AbstractProductA
 {
+public:
     std::string UsefulFunctionA() const override
     {
         return "The result of the product A2.";
     }
 };
 
-class ConcreteProductA3 : public AbstractProductA
+class ConcreteProductA3 final : public AbstractProductA
 {
+public:
     std::string UsefulFunctionA() const override
     {
         return "The result of the product A3.";
@@ -88,7 +109,7 @@ public:
     virtual std::string AnotherUsefulFunctionB(const AbstractProductA &collaborator) const = 0;
 };
 
-class ConcreteProductB1 : public AbstractProductB
+class ConcreteProductB1 final : public AbstractProductB
 {
 public:
     std::string UsefulFunctionB() const override
@@ -102,7 +123,7 @@ public:
     }
 };
 
-class ConcreteProductB2 : public AbstractProductB
+class ConcreteProductB2 final : public AbstractProductB
 {
 public:
     std::string UsefulFunctionB() const override
@@ -116,7 +137,7 @@ public:
     }
 };
 
-class ConcreteProductB3 : public AbstractProductB
+class ConcreteProductB3 final : public AbstractProductB
 {
 public:
     std::string UsefulFunctionB() const override
@@ -146,7 +167,7 @@ public:
     virtual std::string SecondAnotherUsefulFunctionC(const AbstractProductB &collaborator) const = 0;
 };
 
-class ConcreteProductC1 : public AbstractProductC
+class ConcreteProductC1 final : public AbstractProductC
 {
 public:
     std::string UsefulFunctionC() const override
@@ -165,7 +186,7 @@ public:
         return "The result of the C1 collaborating with ( " + result + " )";
     }
 };
-class ConcreteProductC2 : public AbstractProductC
+class ConcreteProductC2 final : public AbstractProductC
 {
 public:
     std::string UsefulFunctionC() const override
@@ -194,9 +215,10 @@ public:
 class AbstractFactory
 {
 public:
-    virtual AbstractProductA *CreateProductA() const = 0;
-    virtual AbstractProductB *CreateProductB() const = 0;
-    virtual AbstractProductC *CreateProductC() const = 0;
+    virtual ~AbstractFactory(){};
+    virtual std::unique_ptr<AbstractProductA> CreateProductA() const = 0;
+    virtual std::unique_ptr<AbstractProductB> CreateProductB() const = 0;
+    virtual std::unique_ptr<AbstractProductC> CreateProductC() const = 0;
 };
 
 /**
@@ -204,63 +226,108 @@ public:
  * Fabryka gwarantuje, że powstałe produkty są ze sobą kompatybilne.
  *
  */
-class ConcreteFactory1 : public AbstractFactory
+class ConcreteFactory1 final : public AbstractFactory
 {
 public:
-    AbstractProductA *CreateProductA() const override
+    /**
+     * Niewirtualne metody zwracające konkretne produkty, używane przez ConcreteClientCode;
+     * wirtualne CreateProductX również je wywołują
+     */
+    std::unique_ptr<ConcreteProductA1> CreateConcreteProductA() const
+    {
+        return std::unique_ptr<ConcreteProductA1>(new ConcreteProductA1());
+    }
+    std::unique_ptr<ConcreteProductB1> CreateConcreteProductB() const
+    {
+        return std::unique_ptr<ConcreteProductB1>(new ConcreteProductB1());
+    }
+    std::unique_ptr<ConcreteProductC1> CreateConcreteProductC() const
+    {
+        return std::unique_ptr<ConcreteProductC1>(new ConcreteProductC1());
+    }
+
+    std::unique_ptr<AbstractProductA> CreateProductA() const override
     {
-        return new ConcreteProductA1();
+        return CreateConcreteProductA();
     }
     /**
      * Funkcje metod fabryki zwracają abstrakcyjny produkt,
      * podczas gdy wewnątrz metody powstaje konkretny produkt.
+     * Produkt jest zwracany w std::unique_ptr, więc zwalnia się sam u klienta.
      */
-    AbstractProductB *CreateProductB() const override
+    std::unique_ptr<AbstractProductB> CreateProductB() const override
     {
-        return new ConcreteProductB1();
+        return CreateConcreteProductB();
     }
 
-    AbstractProductC *CreateProductC() const override
+    std::unique_ptr<AbstractProductC> CreateProductC() const override
     {
-        return new ConcreteProductC1();
+        return CreateConcreteProductC();
     }
 };
 
 /**
  * To samo co w przypadku wyżej
  */
-class ConcreteFactory2 : public AbstractFactory
+class ConcreteFactory2 final : public AbstractFactory
 {
 public:
-    AbstractProductA *CreateProductA() const override
+    std::unique_ptr<ConcreteProductA2> CreateConcreteProductA() const
+    {
+        return std::unique_ptr<ConcreteProductA2>(new ConcreteProductA2());
+    }
+    std::unique_ptr<ConcreteProductB2> CreateConcreteProductB() const
+    {
+        return std::unique_ptr<ConcreteProductB2>(new ConcreteProductB2());
+    }
+    std::unique_ptr<ConcreteProductC2> CreateConcreteProductC() const
+    {
+        return std::unique_ptr<ConcreteProductC2>(new ConcreteProductC2());
+    }
+
+    std::unique_ptr<AbstractProductA> CreateProductA() const override
     {
-        return new ConcreteProductA2();
+        return CreateConcreteProductA();
     }
-    AbstractProductB *CreateProductB() const override
+    std::unique_ptr<AbstractProductB> CreateProductB() const override
     {
-        return new ConcreteProductB2();
+        return CreateConcreteProductB();
     }
-    AbstractProductC *CreateProductC() const override
+    std::unique_ptr<AbstractProductC> CreateProductC() const override
     {
-        return new ConcreteProductC2();
+        return CreateConcreteProductC();
     }
 };
 
-class ConcreteFactory3 : public AbstractFactory
+class ConcreteFactory3 final : public AbstractFactory
 {
 public:
-    AbstractProductA *CreateProductA() const override
+    std::unique_ptr<ConcreteProductA3> CreateConcreteProductA() const
     {
-        return new ConcreteProductA3();
+        return std::unique_ptr<ConcreteProductA3>(new ConcreteProductA3());
     }
-    AbstractProductB *CreateProductB() const override
+    std::unique_ptr<ConcreteProductB3> CreateConcreteProductB() const
     {
-        return new ConcreteProductB3();
+        return std::unique_ptr<ConcreteProductB3>(new ConcreteProductB3());
+    }
+    // produkt C3 nie istnieje
+    std::unique_ptr<AbstractProductC> CreateConcreteProductC() const
+    {
+        return nullptr;
     }
 
-    AbstractProductC *CreateProductC() const override
+    std::unique_ptr<AbstractProductA> CreateProductA() const override
     {
-        return 0;
+        return CreateConcreteProductA();
+    }
+    std::unique_ptr<AbstractProductB> CreateProductB() const override
+    {
+        return CreateConcreteProductB();
+    }
+
+    std::unique_ptr<AbstractProductC> CreateProductC() const override
+    {
+        return nullptr;
     }
 };
 
@@ -271,17 +338,97 @@ public:
 
 void ClientCode(const AbstractFactory &factory)
 {
-    const AbstractProductA *product_a = factory.CreateProductA();
-    const AbstractProductB *product_b = factory.CreateProductB();
-    const AbstractProductC *product_c = factory.CreateProductC();
+    const std::unique_ptr<AbstractProductA> product_a = factory.CreateProductA();
+    const std::unique_ptr<AbstractProductB> product_b = factory.CreateProductB();
+    const std::unique_ptr<AbstractProductC> product_c = factory.CreateProductC();
     std::cout << product_b->UsefulFunctionB() << "\n";
     std::cout << product_b->AnotherUsefulFunctionB(*product_a) << "\n";
-    std::cout << product_c->UsefulFunctionC() << "\n";
-    std::cout << product_c->AnotherUsefulFunctionC(*product_a) << "\n";
-    std::cout << product_c->SecondAnotherUsefulFunctionC(*product_b) << "\n";
-    delete product_a;
-    delete product_b;
-    delete product_c;
+    // fabryka 3 nie ma produktu C
+    if (product_c)
+    {
+        std::cout << product_c->UsefulFunctionC() << "\n";
+        std::cout << product_c->AnotherUsefulFunctionC(*product_a) << "\n";
+        std::cout << product_c->SecondAnotherUsefulFunctionC(*product_b) << "\n";
+    }
+}
+
+/**
+ * Ten sam kod klienta dla konkretnej fabryki: produkty mają konkretne typy (klasy final),
+ * więc metody fabryki, metody produktów i destruktory są wywoływane bezpośrednio.
+ * Wirtualne pozostają tylko wywołania na współpracującym produkcie wewnątrz Another...Function,
+ * bo interfejs produktu przyjmuje go jako typ abstrakcyjny.
+ */
+template <typename Factory>
+void ConcreteClientCode(const Factory &factory)
+{
+    const auto product_a = factory.CreateConcreteProductA();
+    const auto product_b = factory.CreateConcreteProductB();
+    const auto product_c = factory.CreateConcreteProductC();
+    std::cout << product_b->UsefulFunctionB() << "\n";
+    std::cout << product_b->AnotherUsefulFunctionB(*product_a) << "\n";
+    // fabryka 3 nie ma produktu C
+    if (product_c)
+    {
+        std::cout << product_c->UsefulFunctionC() << "\n";
+        std::cout << product_c->AnotherUsefulFunctionC(*product_a) << "\n";
+        std::cout << product_c->SecondAnotherUsefulFunctionC(*product_b) << "\n";
+    }
+}
+
+// pętla monomorficzna dla jednej rodziny; wskaźniki niepuste
+template <typename Factory>
+void ClientCodeGroup(const std::vector<const Factory *> &group)
+{
+    for (const Factory *factory : group)
+    {
+        ConcreteClientCode(*factory);
+    }
+}
+
+/**
+ * Wersja wsadowa ClientCode: fabryki są grupowane według rodziny (1, 2, 3),
+ * a każda grupa przetwarzana jest w osobnej pętli przez ConcreteClientCode.
+ * Fabryki spoza trzech rodzin przechodzą przez zwykły ClientCode.
+ * Wyniki pojawiają się w kolejności rodzin, a nie w kolejności listy.
+ * Puste wskaźniki na liście są pomijane.
+ */
+void ClientCodeBatch(const std::vector<const AbstractFactory *> &factories)
+{
+    std::vector<const ConcreteFactory1 *> family1;
+    std::vector<const ConcreteFactory2 *> family2;
+    std::vector<const ConcreteFactory3 *> family3;
+    std::vector<const AbstractFactory *> others; // fabryki spoza trzech znanych rodzin
+    for (const AbstractFactory *factory : factories)
+    {
+        if (!factory)
+        {
+            continue;
+        }
+        const std::type_info &type = typeid(*factory);
+        if (type == typeid(ConcreteFactory1))
+        {
+            family1.push_back(static_cast<const ConcreteFactory1 *>(factory));
+        }
+        else if (type == typeid(ConcreteFactory2))
+        {
+            family2.push_back(static_cast<const ConcreteFactory2 *>(factory));
+        }
+        else if (type == typeid(ConcreteFactory3))
+        {
+            family3.push_back(static_cast<const ConcreteFactory3 *>(factory));
+        }
+        else
+        {
+            others.push_back(factory);
+        }
+    }
+    ClientCodeGroup(family1);
+    ClientCodeGroup(family2);
+    ClientCodeGroup(family3);
+    for (const AbstractFactory *factory : others)
+    {
+        ClientCode(*factory);
+    }
 }
 
 int main()
@@ -300,5 +447,10 @@ int main()
     ConcreteFactory3 *f3 = new ConcreteFactory3();
     ClientCode(*f3);
     delete f3;
+    std::cout << std::endl;
+    std::cout << "Client: Testing batched client code grouped by factory type:\n";
+    ConcreteFactory1 batch_f1;
+    ConcreteFactory2 batch_f2;
+    ClientCodeBatch({&batch_f2, &batch_f1, &batch_f2});
     return 0;
 }
@@ -28,6 +28,7 @@ Product parts: PartB1, PartC1, PartD1
  */
 
 #include <iostream>
+#include <memory>
 #include <vector>
 
 class Product1
@@ -63,6 +64,7 @@ public:
     virtual void ProducePartB() const = 0; // metoda tworzenia części B
     virtual void ProducePartC() const = 0; // metoda tworzenia części C
     virtual void ProducePartD() const = 0; // metoda tworzenia części D
+    virtual void ReserveParts(size_t count) const = 0; // rezerwacja miejsca na count kolejnych części
 };
 /**
  * Klasy ConcreteBuilder są zgodne z interfejsem Builder i zapewniają określone implementacje etapów budowania.
@@ -70,22 +72,33 @@ public:
 class ConcreteBuilder1 : public Builder
 {
 private:
-    Product1 *product;
+    std::unique_ptr<Product1> product;
+    size_t parts_capacity_;
 
 public:
-    ConcreteBuilder1()
+    /**
+     * @brief parts_capacity - spodziewana liczba części produktu, rezerwowana przy każdym Reset
+     */
+    explicit ConcreteBuilder1(size_t parts_capacity = 0)
+        : parts_capacity_(parts_capacity)
     {
         this->Reset();
     }
 
-    ~ConcreteBuilder1()
+    void Reset()
     {
-        delete product;
+        this->product.reset(new Product1());
+        this->product->parts_.reserve(parts_capacity_);
     }
 
-    void Reset()
+    /**
+     * @brief Jednorazowa rezerwacja miejsca na count kolejnych części (poza już dodanymi),
+     * aby dodawanie części nie powodowało realokacji
+     *
+     */
+    void ReserveParts(size_t count) const override
     {
-        this->product = new Product1();
+        this->product->parts_.reserve(this->product->parts_.size() + count);
     }
 
     /**
@@ -115,11 +128,11 @@ public:
     /**
      * @brief Pobranie gotowego produktu o określonej konfiguracji
      *
-     * @return Product1*
+     * @return std::unique_ptr<Product1>
      */
-    Product1 *GetProduct()
+    std::unique_ptr<Product1> GetProduct()
     {
-        Product1 *result = this->product;
+        std::unique_ptr<Product1> result = std::move(this->product);
         this->Reset();
         return result;
     }
@@ -141,14 +154,17 @@ public:
 
     /**
      * Konstrukcja produktów o różnej konfiguracji częściowej
+     * Director zna liczbę części każdej konfiguracji, więc rezerwuje miejsce przed budową
      */
     void BuildMinimalViableProduct()
     {
+        this->builder->ReserveParts(1);
         this->builder->ProducePartA();
     }
 
     void BuildFullFeaturedProduct()
     {
+        this->builder->ReserveParts(4);
         this->builder->ProducePartA();
         this->builder->ProducePartB();
         this->builder->ProducePartC();
@@ -157,6 +173,7 @@ public:
 
     void BuildHalfFeaturedProduct()
     {
+        this->builder->ReserveParts(2);
         this->builder->ProducePartA();
         this->builder->ProducePartD();
     }
@@ -172,23 +189,20 @@ void ClientCode(Director &director)
     std::cout << "Standard basic product:\n";
     director.BuildMinimalViableProduct();
 
-    Product1 *p = builder->GetProduct();
+    std::unique_ptr<Product1> p = builder->GetProduct();
     p->ListParts();
-    delete p;
 
     std::cout << "Standard full featured product:\n";
     director.BuildFullFeaturedProduct();
 
     p = builder->GetProduct();
     p->ListParts();
-    delete p;
 
     std::cout << "Standard half featured product:\n";
     director.BuildHalfFeaturedProduct();
 
     p = builder->GetProduct();
     p->ListParts();
-    delete p;
 
     // Builder może być używany bez Director
     std::cout << "Custom product 1:\n";
@@ -197,7 +211,6 @@ void ClientCode(Director &director)
     builder->ProducePartD();
     p = builder->GetProduct();
     p->ListParts();
-    delete p;
 
     std::cout << "Custom product 2:\n";
     builder->ProducePartB();
@@ -205,7 +218,6 @@ void ClientCode(Director &director)
     builder->ProducePartD();
     p = builder->GetProduct();
     p->ListParts();
-    delete p;
 
     delete builder;
 }
@@ -23,6 +23,7 @@ The same creator's code working with {Result of the ConcreteProduct3}
  *
  */
 #include <iostream>
+#include <memory>
 /**
  * Ogólny interface produktu
  */
@@ -65,19 +66,19 @@ public:
 
 /**
  * klasa Creator deklaruje metodę fabryczną, która ma zwrócić obiekt klasy Product. Podklasy Creator zwykle zapewniają implementację tej metody.
+ * Creator i jego podklasy nie mają stanu, a każde wywołanie SomeOperation tworzy i usuwa własny produkt,
+ * więc jedną instancję można bez blokad współdzielić między wieloma wątkami.
  */
 class Creator
 {
 public:
     virtual ~Creator(){};
-    virtual Product *FactoryMethod() const = 0;
+    virtual std::unique_ptr<Product> FactoryMethod() const = 0;
     std::string SomeOperation() const
     {
         // Wywołaj FactoryMethod, aby utworzyć obiekt product.
-        Product *product = this->FactoryMethod();
-        std::string result = "The same creator's code working with " + product->Operation();
-        delete product;
-        return result;
+        std::unique_ptr<Product> product = this->FactoryMethod();
+        return "The same creator's code working with " + product->Operation();
     }
 };
 
@@ -87,27 +88,27 @@ public:
 class ConcreteCreator1 : public Creator
 {
 public:
-    Product *FactoryMethod() const override
+    std::unique_ptr<Product> FactoryMethod() const override
     {
-        return new ConcreteProduct1();
+        return std::unique_ptr<Product>(new ConcreteProduct1());
     }
 };
 
 class ConcreteCreator2 : public Creator
 {
 public:
-    Product *FactoryMethod() const override
+    std::unique_ptr<Product> FactoryMethod() const override
     {
-        return new ConcreteProduct2();
+        return std::unique_ptr<Product>(new ConcreteProduct2());
     }
 };
 
 class ConcreteCreator3 : public Creator
 {
 public:
-    Product *FactoryMethod() const override
+    std::unique_ptr<Product> FactoryMethod() const override
     {
-        return new ConcreteProduct3();
+        return std::unique_ptr<Product>(new ConcreteProduct3());
     }
 };
 
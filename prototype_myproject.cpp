@@ -17,6 +17,8 @@ Method from PROTOTYPE_3  with field: 40 with id: 192.168.21.3
  */
 
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 using std::string;
 
@@ -35,20 +37,21 @@ enum Type
 class Prototype
 {
 protected:
+    // pola używane przez Method leżą razem z vptr na początku obiektu (pierwsze 44 bajty na x86-64); rzadko używane id na końcu
     string prototype_name_;
     float prototype_field_;
     string prototype_id_;
 
 public:
     Prototype() {}
-    Prototype(string prototype_name)
+    Prototype(const string &prototype_name)
         : prototype_name_(prototype_name)
     {
     }
 
     virtual ~Prototype() {}
-    virtual Prototype *Clone() const = 0;
-    virtual void Method(float prototype_field, string prototype_id)
+    virtual std::unique_ptr<Prototype> Clone() const = 0;
+    virtual void Method(float prototype_field, const string &prototype_id)
     {
         this->prototype_field_ = prototype_field;
         std::cout << "Method from " << prototype_name_ << " with field: " << prototype_field << " with id: " << prototype_id << std::endl;
@@ -67,14 +70,14 @@ private:
     string concrete_prototype_id1_;
 
 public:
-    ConcretePrototype1(string prototype_name, float concrete_prototype_field, string concrete_prototype_id)
+    ConcretePrototype1(const string &prototype_name, float concrete_prototype_field, const string &concrete_prototype_id)
         : Prototype(prototype_name), concrete_prototype_field1_(concrete_prototype_field), concrete_prototype_id1_(concrete_prototype_id)
     {
     }
 
-    Prototype *Clone() const override
+    std::unique_ptr<Prototype> Clone() const override
     {
-        return new ConcretePrototype1(*this); // zwolnienie pamięci po stronie klienta
+        return std::unique_ptr<Prototype>(new ConcretePrototype1(*this)); // unique_ptr zwalnia pamięć po stronie klienta
     }
 };
 
@@ -85,13 +88,13 @@ private:
     string concrete_prototype_id2_;
 
 public:
-    ConcretePrototype2(string prototype_name, float concrete_prototype_field, string concrete_prototype_id)
+    ConcretePrototype2(const string &prototype_name, float concrete_prototype_field, const string &concrete_prototype_id)
         : Prototype(prototype_name), concrete_prototype_field2_(concrete_prototype_field), concrete_prototype_id2_(concrete_prototype_id)
     {
     }
-    Prototype *Clone() const override
+    std::unique_ptr<Prototype> Clone() const override
     {
-        return new ConcretePrototype2(*this);
+        return std::unique_ptr<Prototype>(new ConcretePrototype2(*this));
     }
 };
 
@@ -102,55 +105,89 @@ private:
     string concrete_prototype_id3_;
 
 public:
-    ConcretePrototype3(string prototype_name, float concrete_prototype_field, string concrete_prototype_id)
+    ConcretePrototype3(const string &prototype_name, float concrete_prototype_field, const string &concrete_prototype_id)
         : Prototype(prototype_name), concrete_prototype_field1_(concrete_prototype_field), concrete_prototype_id3_(concrete_prototype_id)
     {
     }
 
-    Prototype *Clone() const override
+    std::unique_ptr<Prototype> Clone() const override
     {
-        return new ConcretePrototype3(*this);
+        return std::unique_ptr<Prototype>(new ConcretePrototype3(*this));
     }
 };
 
 /**
- * @brief Fabryka prototypów, w którym tworzone są 3 prototypy
+ * @brief Budżet rozmiaru prototypów równy obecnemu układowi (float zajmuje jedno miejsce wyrównane do string);
+ * zwiększenie rozmiaru klasy przerywa kompilację, pole mieszczące się w istniejącym paddingu nie jest wykrywane
+ *
+ */
+static_assert(sizeof(Prototype) <= sizeof(void *) + 2 * sizeof(string) + alignof(string),
+              "Prototype przekroczył budżet rozmiaru");
+static_assert(sizeof(ConcretePrototype1) <= sizeof(Prototype) + sizeof(string) + alignof(string),
+              "ConcretePrototype1 przekroczył budżet rozmiaru");
+static_assert(sizeof(ConcretePrototype2) <= sizeof(Prototype) + sizeof(string) + alignof(string),
+              "ConcretePrototype2 przekroczył budżet rozmiaru");
+static_assert(sizeof(ConcretePrototype3) <= sizeof(Prototype) + sizeof(string) + alignof(string),
+              "ConcretePrototype3 przekroczył budżet rozmiaru");
+
+/**
+ * @brief Fabryka prototypów, w którym rejestrowane są 3 prototypy
  * float concrete_prototype_field, std::string concrete_prototype_id dowolne
+ * Prototyp danego typu powstaje dopiero przy pierwszym CreatePrototype tego typu.
  *
  */
 
 class PrototypeFactory
 {
 private:
-    std::unordered_map<Type, Prototype *, std::hash<int>> prototypes_;
+    /**
+     * @brief Wpis rejestru: funkcja tworząca prototyp oraz prototyp utworzony przy pierwszym użyciu
+     *
+     */
+    struct Registration
+    {
+        std::unique_ptr<Prototype> (*make_)() = nullptr;
+        std::once_flag once_;
+        std::unique_ptr<Prototype> prototype_;
+    };
+
+    std::unordered_map<Type, Registration, std::hash<int>> prototypes_;
 
 public:
     PrototypeFactory()
     {
-        prototypes_[Type::PROTOTYPE_1] = new ConcretePrototype1("PROTOTYPE_1 ", 0.f, "");
-        prototypes_[Type::PROTOTYPE_2] = new ConcretePrototype2("PROTOTYPE_2 ", 0.f, "");
-        prototypes_[Type::PROTOTYPE_3] = new ConcretePrototype3("PROTOTYPE_3 ", 0.f, "");
+        Register(Type::PROTOTYPE_1, []() { return std::unique_ptr<Prototype>(new ConcretePrototype1("PROTOTYPE_1 ", 0.f, "")); });
+        Register(Type::PROTOTYPE_2, []() { return std::unique_ptr<Prototype>(new ConcretePrototype2("PROTOTYPE_2 ", 0.f, "")); });
+        Register(Type::PROTOTYPE_3, []() { return std::unique_ptr<Prototype>(new ConcretePrototype3("PROTOTYPE_3 ", 0.f, "")); });
     }
 
-    ~PrototypeFactory()
+    /**
+     * @brief Rejestracja typu prototypu; sam prototyp nie jest jeszcze tworzony
+     * Rejestracja musi się zakończyć zanim fabryka zostanie użyta przez wiele wątków.
+     *
+     */
+
+    void Register(Type type, std::unique_ptr<Prototype> (*make)())
     {
-        delete prototypes_[Type::PROTOTYPE_1];
-        delete prototypes_[Type::PROTOTYPE_2];
-        delete prototypes_[Type::PROTOTYPE_3];
+        prototypes_[type].make_ = make;
     }
 
     /**
      * @brief Określenie typu prototypu; metoda "sama" tworzy obiekt o tym typie
+     * Przy pierwszym wywołaniu dla danego typu tworzony jest prototyp (dokładnie raz, również przy wielu wątkach).
      *
      */
 
-    Prototype *CreatePrototype(Type type)
+    std::unique_ptr<Prototype> CreatePrototype(Type type)
     {
-        return prototypes_[type]->Clone();
+        Registration &registration = prototypes_.at(type);
+        std::call_once(registration.once_, [&registration]()
+                       { registration.prototype_ = registration.make_(); });
+        return registration.prototype_->Clone();
     }
 };
 /**
- * @brief Klasa klienta; Tworzenie prototypów, wywoływanie metody i usuwanie prototypów po stronie klienta
+ * @brief Klasa klienta; Tworzenie prototypów i wywoływanie metody, prototypy usuwa unique_ptr po stronie klienta
  *
  * @param prototype_factory
  */
@@ -159,17 +196,14 @@ void Client(PrototypeFactory &prototype_factory)
 {
     std::cout << "Making prototypes" << std::endl;
 
-    Prototype *prototype = prototype_factory.CreatePrototype(Type::PROTOTYPE_1);
+    std::unique_ptr<Prototype> prototype = prototype_factory.CreatePrototype(Type::PROTOTYPE_1);
     prototype->Method(90, "192.168.21.1");
-    delete prototype;
 
     prototype = prototype_factory.CreatePrototype(Type::PROTOTYPE_2);
     prototype->Method(10, "192.168.21.2");
-    delete prototype;
 
     prototype = prototype_factory.CreatePrototype(Type::PROTOTYPE_3);
     prototype->Method(40, "192.168.21.3");
-    delete prototype;
 }
 
 int main()